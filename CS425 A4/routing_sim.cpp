@@ -5,201 +5,2265 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 using namespace std;
 
-const int INF = 9999;
+// Link cost that marks "no link" in input files; unreachable destinations
+// are printed with it too.
+const int NO_LINK = 9999;
 
-void printDVRTable(int node, const vector<vector<int>>& table, const vector<vector<int>>& nextHop) {
-    cout << "Node " << node << " Routing Table:\n";
-    cout << "Dest\tCost\tNext Hop\n";
-    for (int i = 0; i < table.size(); ++i) {
-        cout << i << "\t" << table[node][i] << "\t";
-        if (nextHop[node][i] == -1) cout << "-";
-        else cout << nextHop[node][i];
-        cout << endl;
-    }
-    cout << endl;
+// Path costs are 64-bit, so long paths in large networks do not overflow.
+// INF marks an unreachable destination; it is far above any real path cost,
+// and the sum of two costs up to INF still fits. (Text tables still print
+// unreachable as NO_LINK, the CSV and binary exports as -1.)
+typedef long long Cost;
+const Cost INF = numeric_limits<Cost>::max() / 4;
+
+/*
+ * Compressed sparse row (CSR) representation of the network.
+ * The links leaving node u are edges[offset[u]] .. edges[offset[u+1]-1],
+ * sorted by destination, so a node's neighbours are scanned in O(degree)
+ * instead of O(n) and the whole graph takes O(n + m) memory.
+ */
+struct Edge {
+    int to;
+    int cost;
+};
+
+struct CSRGraph {
+    int n = 0;
+    vector<size_t> offset; // n + 1 entries
+    vector<Edge> edges;
+
+    const Edge* begin(int u) const { return edges.data() + offset[u]; }
+    const Edge* end(int u) const { return edges.data() + offset[u + 1]; }
+};
+
+int maxLinkCost(const CSRGraph& graph) {
+    int most = 0;
+    for (const Edge& e : graph.edges) most = max(most, e.cost);
+    return most;
 }
 
-void simulateDVR(const vector<vector<int>>& graph) {
-    int n = graph.size();
-    vector<vector<int>> dist = graph;
-    vector<vector<int>> nextHop(n, vector<int>(n,-1));
+/*
+ * Work-stealing thread pool. run(count, task) deals [0, count) out to the
+ * workers as contiguous ranges; a worker takes items from the front of its
+ * own range and, once that is empty, steals the back half of another
+ * worker's range. Each range is a single atomic word (begin << 32 | end) so
+ * both sides claim items with one compare-and-swap. The calling thread acts
+ * as worker 0.
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads)
+        : ranges(max(threads, 1)) {
+        for (int w = 1; w < (int)ranges.size(); ++w)
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, w);
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& t : workers) t.join();
+    }
+
+    int size() const { return ranges.size(); }
 
-    //TODO: Complete this
-      // Initialize distance and nextHop matrices
-for(int i=0; i<n; ++i) {
-    for(int j=0; j<n; ++j) {
-        if(i == j) {
-            // Distance to self is always 0; no next hop needed
-            dist[i][j] = 0;
-            nextHop[i][j] = -1;
+    // Calls task(worker, item) for every item in [0, count) and waits for
+    // all of them to finish.
+    void run(int count, const function<void(int, int)>& fn) {
+        int threads = ranges.size();
+        for (int w = 0; w < threads; ++w) {
+            uint64_t begin = (uint64_t)count * w / threads;
+            uint64_t end = (uint64_t)count * (w + 1) / threads;
+            ranges[w].bounds.store(begin << 32 | end);
         }
-        else if(graph[i][j] == INF) {
-            // No direct link: set distance to INF and next hop to -1 (unreachable)
-            dist[i][j] = INF;
-            nextHop[i][j] = -1;
+        {
+            lock_guard<mutex> lock(m);
+            task = &fn;
+            busy = threads - 1;
+            ++generation;
         }
-        else {
-            // Direct neighbor: set distance to direct cost and next hop to neighbor
-            dist[i][j] = graph[i][j];
-            nextHop[i][j] = j;
+        wake.notify_all();
+        work(0);
+        unique_lock<mutex> lock(m);
+        done.wait(lock, [this] { return busy == 0; });
+        task = nullptr;
+    }
+
+private:
+    struct alignas(64) Range {
+        atomic<uint64_t> bounds{0};
+    };
+
+    bool popLocal(int w, int& item) {
+        uint64_t b = ranges[w].bounds.load();
+        while (true) {
+            uint32_t begin = b >> 32, end = (uint32_t)b;
+            if (begin >= end) return false;
+            if (ranges[w].bounds.compare_exchange_weak(b, (uint64_t)(begin + 1) << 32 | end)) {
+                item = begin;
+                return true;
+            }
         }
     }
-}
+
+    bool steal(int w, int& item) {
+        int threads = ranges.size();
+        for (int i = 1; i < threads; ++i) {
+            Range& victim = ranges[(w + i) % threads];
+            uint64_t b = victim.bounds.load();
+            while (true) {
+                uint32_t begin = b >> 32, end = (uint32_t)b;
+                if (begin >= end) break;
+                uint32_t mid = begin + (end - begin) / 2;
+                if (victim.bounds.compare_exchange_weak(b, (uint64_t)begin << 32 | mid)) {
+                    // Our own range is empty, so nobody else touches it
+                    // until the stolen remainder is published.
+                    item = mid;
+                    ranges[w].bounds.store((uint64_t)(mid + 1) << 32 | end);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void work(int w) {
+        int item;
+        while (popLocal(w, item) || steal(w, item)) (*task)(w, item);
+    }
+
+    void workerLoop(int w) {
+        int seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(m);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            work(w);
+            lock_guard<mutex> lock(m);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+
+    vector<Range> ranges;
+    vector<thread> workers;
+    mutex m;
+    condition_variable wake, done;
+    const function<void(int, int)>* task = nullptr;
+    int generation = 0;
+    int busy = 0;
+    bool stopping = false;
+};
 
 /*
- * Main Distance Vector Routing (DVR) update loop.
- * Each node updates its routing table by considering all possible intermediate nodes (k).
- * If a shorter path to destination j via neighbor k is found, update the cost and next hop.
- * Repeat this process until no updates occur (convergence).
+ * Text output goes through a buffered writer that formats integers by hand
+ * and hands the file large blocks, instead of flushing a stream per line.
  */
-bool updated;
-do {
-    updated = false;
+class BufferedWriter {
+public:
+    explicit BufferedWriter(FILE* file) : file(file), buf(1 << 20) {}
+    ~BufferedWriter() { flush(); }
 
-    // Make copies to store new distances and next hops for this iteration
-    vector<vector<int>> newDist = dist;
-    vector<vector<int>> newNextHop = nextHop;
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
 
-    // For each node i (source)
-    for(int i=0; i<n; ++i) {
-        // For each possible destination j
-        for(int j=0; j<n; ++j) {
-            if(i == j) continue; // Skip self
+    void put(char c) {
+        if (len == buf.size()) flush();
+        buf[len++] = c;
+    }
 
-            int minCost = newDist[i][j];    // Current known minimum cost from i to j
-            int minHop = newNextHop[i][j];  // Current known next hop from i to j
+    void put(const char* s) {
+        while (*s) put(*s++);
+    }
 
-            // Try all possible neighbors k as intermediate nodes
-            for(int k=0; k<n; ++k) {
-                if(k == i || dist[i][k] == INF) continue; // Skip self and unreachable neighbors
+    void putInt(long long v) {
+        char digits[24];
+        int k = 0;
+        unsigned long long u = v < 0 ? 0ULL - v : v;
+        do {
+            digits[k++] = '0' + u % 10;
+            u /= 10;
+        } while (u);
+        if (v < 0) put('-');
+        while (k) put(digits[--k]);
+    }
 
-                int newCost = dist[i][k] + dist[k][j]; // Cost to go from i to j via k
+    void flush() {
+        if (len) fwrite(buf.data(), 1, len, file);
+        len = 0;
+    }
 
-                // If a shorter path is found via neighbor k
-                if(newCost < minCost) {
-                    minCost = newCost;
-                    minHop = k;
-                }
+private:
+    FILE* file;
+    vector<char> buf;
+    size_t len = 0;
+};
+
+enum class TableKind { DVR, AsyncDV, LSR };
+const int TABLE_KINDS = 3;
+const char* const TABLE_NAMES[TABLE_KINDS] = {"dvr", "async-dv", "lsr"};
+
+struct OutputOptions {
+    string nodes;      // e.g. "0,4,10-12"; empty selects every node
+    string csvFile;
+    string binaryFile;
+    string diffFile;   // binary export to compare against
+};
+
+/*
+ * Destination of every routing table the simulations produce. A table is
+ * printed as text (DV tables list every destination and "-" for no next
+ * hop; LSR tables skip the node itself; unreachable costs show as NO_LINK),
+ * and can also be exported, with -1 as the cost of unreachable entries:
+ *   - CSV: one "table,node,dest,cost,next_hop" line per entry;
+ *   - binary: a header ("RTBL", version 2, n as native-endian int32) and
+ *     per table int32 kind and node, n int64 costs and n int32 next hops.
+ * Only the selected nodes are emitted. Given the binary export of an
+ * earlier run, text and CSV output is reduced to the entries that differ
+ * from it, each printed with its old cost and next hop.
+ */
+class TableOutput {
+public:
+    TableOutput(int n, const OutputOptions& options) : n(n), text(stdout), diffing(!options.diffFile.empty()) {
+        selectNodes(options.nodes);
+        if (!options.csvFile.empty()) {
+            csvFile = openOutput(options.csvFile);
+            csv = make_unique<BufferedWriter>(csvFile);
+            csv->put("table,node,dest,cost,next_hop\n");
+        }
+        if (!options.binaryFile.empty()) {
+            binaryFile = openOutput(options.binaryFile);
+            int32_t header[3];
+            memcpy(header, "RTBL", 4);
+            header[1] = 2;
+            header[2] = n;
+            fwrite(header, sizeof(header), 1, binaryFile);
+        }
+        if (diffing) loadBaseline(options.diffFile);
+    }
+
+    ~TableOutput() {
+        flush();
+        csv.reset();
+        if (csvFile) fclose(csvFile);
+        if (binaryFile) fclose(binaryFile);
+    }
+
+    // The selected nodes in ascending order.
+    const vector<int>& nodes() const { return selected; }
+
+    void table(TableKind kind, int node, const Cost* dist, const int* nextHop) {
+        if (!isSelected[node]) return;
+        const Cost* oldDist = nullptr;
+        const int* oldHop = nullptr;
+        if (diffing && loadBaselineTable(kind, node)) {
+            oldDist = baselineDist.data();
+            oldHop = baselineHop.data();
+        }
+        bool dvStyle = kind != TableKind::LSR;
+        bool header = false;
+        if (!diffing) printHeader(node, header);
+        for (int i = 0; i < n; ++i) {
+            if (oldDist && dist[i] == oldDist[i] && nextHop[i] == oldHop[i]) continue;
+            if (csv) {
+                csv->put(TABLE_NAMES[(int)kind]);
+                csv->put(',');
+                csv->putInt(node);
+                csv->put(',');
+                csv->putInt(i);
+                csv->put(',');
+                csv->putInt(dist[i] == INF ? -1 : dist[i]);
+                csv->put(',');
+                csv->putInt(nextHop[i]);
+                csv->put('\n');
+            }
+            if (!dvStyle && i == node) continue;
+            printHeader(node, header);
+            text.putInt(i);
+            text.put('\t');
+            text.putInt(dist[i] == INF ? NO_LINK : dist[i]);
+            text.put('\t');
+            if (dvStyle && nextHop[i] == -1) text.put('-');
+            else text.putInt(nextHop[i]);
+            if (oldDist) {
+                text.put("\t(was ");
+                text.putInt(oldDist[i] == INF ? NO_LINK : oldDist[i]);
+                text.put(' ');
+                text.putInt(oldHop[i]);
+                text.put(')');
             }
+            text.put('\n');
+        }
+        if (header) text.put('\n');
 
-            // If a shorter path was found, update the new tables and mark as updated
-            if(minCost < newDist[i][j]) {
-                newDist[i][j] = minCost;
-                newNextHop[i][j] = minHop;
-                updated = true;
+        if (binaryFile) {
+            int32_t ids[2] = {(int32_t)kind, node};
+            fwrite(ids, sizeof(ids), 1, binaryFile);
+            exportDist.resize(n);
+            for (int i = 0; i < n; ++i) exportDist[i] = dist[i] == INF ? -1 : dist[i];
+            fwrite(exportDist.data(), sizeof(int64_t), n, binaryFile);
+            fwrite(nextHop, sizeof(int32_t), n, binaryFile);
+        }
+    }
+
+    // Hands the buffered text to stdout; call before printing with cout.
+    void flush() {
+        text.flush();
+    }
+
+private:
+    void printHeader(int node, bool& printed) {
+        if (printed) return;
+        printed = true;
+        text.put("Node ");
+        text.putInt(node);
+        text.put(" Routing Table:\nDest\tCost\tNext Hop\n");
+    }
+
+    static FILE* openOutput(const string& filename) {
+        FILE* file = fopen(filename.c_str(), "wb");
+        if (!file) {
+            cerr << "Error: Could not open file " << filename << endl;
+            exit(1);
+        }
+        return file;
+    }
+
+    void selectNodes(const string& list) {
+        isSelected.assign(n, list.empty());
+        stringstream ss(list);
+        string item;
+        while (getline(ss, item, ',')) {
+            // Each item is a node "a" or a range "a-b" and nothing else
+            const char* text = item.c_str();
+            char* end;
+            long first = strtol(text, &end, 10), last = first;
+            bool valid = isdigit((unsigned char)text[0]);
+            if (valid && *end == '-') {
+                const char* second = end + 1;
+                last = strtol(second, &end, 10);
+                valid = isdigit((unsigned char)second[0]);
             }
+            if (!valid || *end != '\0' || last >= n || first > last) {
+                cerr << "Error: Invalid node selection " << item << endl;
+                exit(1);
+            }
+            for (int v = first; v <= last; ++v) isSelected[v] = 1;
+        }
+        for (int v = 0; v < n; ++v)
+            if (isSelected[v]) selected.push_back(v);
+    }
+
+    void loadBaseline(const string& filename) {
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open file " << filename << endl;
+            exit(1);
+        }
+        baseline.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        int32_t header[3];
+        size_t record = 2 * sizeof(int32_t) + n * (sizeof(int64_t) + sizeof(int32_t));
+        bool valid = baseline.size() >= sizeof(header) && (baseline.size() - sizeof(header)) % record == 0;
+        if (valid) {
+            memcpy(header, baseline.data(), sizeof(header));
+            valid = memcmp(header, "RTBL", 4) == 0 && header[1] == 2 && header[2] == n;
+        }
+        if (!valid) {
+            cerr << "Error: " << filename << " is not a routing table export for " << n << " nodes" << endl;
+            exit(1);
+        }
+        baselineAt.assign((size_t)TABLE_KINDS * n, -1);
+        for (size_t at = sizeof(header); at < baseline.size(); at += record) {
+            int32_t ids[2];
+            memcpy(ids, &baseline[at], sizeof(ids));
+            if (ids[0] >= 0 && ids[0] < TABLE_KINDS && ids[1] >= 0 && ids[1] < n)
+                baselineAt[(size_t)ids[0] * n + ids[1]] = at + sizeof(ids);
+        }
+    }
+
+    // Unpacks the baseline copy of a table; false if it has none.
+    bool loadBaselineTable(TableKind kind, int node) {
+        long long at = baselineAt[(size_t)kind * n + node];
+        if (at < 0) return false;
+        baselineDist.resize(n);
+        baselineHop.resize(n);
+        for (int i = 0; i < n; ++i) {
+            int64_t cost;
+            memcpy(&cost, &baseline[at + i * sizeof(int64_t)], sizeof(cost));
+            baselineDist[i] = cost < 0 ? INF : cost;
+        }
+        memcpy(baselineHop.data(), &baseline[at + n * sizeof(int64_t)], n * sizeof(int32_t));
+        return true;
+    }
+
+    int n;
+    BufferedWriter text;
+    FILE* csvFile = nullptr;
+    unique_ptr<BufferedWriter> csv;
+    FILE* binaryFile = nullptr;
+    vector<char> isSelected;
+    vector<int> selected;
+    bool diffing;
+    vector<char> baseline;        // the whole baseline export
+    vector<long long> baselineAt; // kind * n + node -> offset of its costs
+    vector<Cost> baselineDist;
+    vector<int> baselineHop;
+    vector<int64_t> exportDist;
+};
+
+/*
+ * Min-plus relaxation of one tile of row i through intermediate node k:
+ * best[j] = min(best[j], costIK + rowK[j]), recording k as the next hop of
+ * every entry it improves. Only strict improvements count, so when several
+ * k give the same cost the first one relaxed keeps the entry. Returns true
+ * if any entry improved.
+ */
+bool relaxTile(const int32_t* rowK, int32_t costIK, int k, int32_t* best, int* hop, int len) {
+    int j = 0;
+    bool improved = false;
+#ifdef __AVX2__
+    __m256i vCost = _mm256_set1_epi32(costIK);
+    __m256i vHop = _mm256_set1_epi32(k);
+    for (; j + 8 <= len; j += 8) {
+        __m256i cand = _mm256_add_epi32(vCost, _mm256_loadu_si256((const __m256i*)(rowK + j)));
+        __m256i cur = _mm256_loadu_si256((const __m256i*)(best + j));
+        __m256i less = _mm256_cmpgt_epi32(cur, cand);
+        if (_mm256_testz_si256(less, less)) continue; // the common case once routes settle
+        _mm256_storeu_si256((__m256i*)(best + j), _mm256_min_epi32(cur, cand));
+        __m256i h = _mm256_loadu_si256((const __m256i*)(hop + j));
+        _mm256_storeu_si256((__m256i*)(hop + j), _mm256_blendv_epi8(h, vHop, less));
+        improved = true;
+    }
+#endif
+    for (; j < len; ++j) {
+        int32_t cand = costIK + rowK[j];
+        if (cand < best[j]) {
+            best[j] = cand;
+            hop[j] = k;
+            improved = true;
         }
     }
+    return improved;
+}
 
-    // If any updates were made in this iteration, copy new tables for the next round
-    if(updated) {
-        dist = newDist;
-        nextHop = newNextHop;
+// The same on 64-bit costs, for networks whose paths may not fit in 32 bits.
+bool relaxTile(const Cost* rowK, Cost costIK, int k, Cost* best, int* hop, int len) {
+    int j = 0;
+    bool improved = false;
+#ifdef __AVX2__
+    // Four 64-bit costs per vector; the lane masks are narrowed to 32 bits
+    // to blend the matching four next hops.
+    __m256i vCost = _mm256_set1_epi64x(costIK);
+    __m128i vHop = _mm_set1_epi32(k);
+    const __m256i lowHalves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    for (; j + 4 <= len; j += 4) {
+        __m256i cand = _mm256_add_epi64(vCost, _mm256_loadu_si256((const __m256i*)(rowK + j)));
+        __m256i cur = _mm256_loadu_si256((const __m256i*)(best + j));
+        __m256i less = _mm256_cmpgt_epi64(cur, cand);
+        if (_mm256_testz_si256(less, less)) continue; // the common case once routes settle
+        _mm256_storeu_si256((__m256i*)(best + j), _mm256_blendv_epi8(cur, cand, less));
+        __m128i mask = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(less, lowHalves));
+        __m128i h = _mm_loadu_si128((const __m128i*)(hop + j));
+        _mm_storeu_si128((__m128i*)(hop + j), _mm_blendv_epi8(h, vHop, mask));
+        improved = true;
+    }
+#endif
+    for (; j < len; ++j) {
+        Cost cand = costIK + rowK[j];
+        if (cand < best[j]) {
+            best[j] = cand;
+            hop[j] = k;
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+/*
+ * Distance Vector Routing as a synchronous min-plus fixed point:
+ *   dist'[i][j] = min(dist[i][j], min over k of dist[i][k] + dist[k][j])
+ * with the next hop of an improved entry set to the k that gave it.
+ * Tables are contiguous row-major n x n arrays. Each round reads the
+ * previous distances from one buffer and writes the new ones to the other,
+ * so no table is copied or reallocated between rounds.
+ *
+ * Rounds are incremental. An entry can only improve through a k whose row,
+ * or whose cost dist[i][k], changed in the previous round; every other k
+ * was already tried against the same values. So row i is swept only over
+ * the rows that changed last round plus, if row i itself changed, the
+ * columns that changed in it. This gives exactly the tables of the full
+ * triple loop, ties included, because skipped k can never win.
+ *
+ * The sweep is tiled: a block of rows is processed one column tile at a
+ * time so the tiles of rows k stay in cache while every row of the block
+ * relaxes through them. Row blocks run in parallel. Returns the number of
+ * rounds.
+ */
+template <typename T>
+int minPlusRounds(const CSRGraph& graph, int threads, T inf, vector<T>& dist, vector<int>& nextHop) {
+    const int ROW_BLOCK = 32, TILE = 1024;
+    int n = graph.n;
+    size_t N = n;
+    // cur holds the distances of the last round, next receives the new ones
+    vector<T> cur(N * N, inf), next(N * N);
+    nextHop.assign(N * N, -1);
+
+    // Initialize distance and nextHop matrices
+    for (int i = 0; i < n; ++i) {
+        // Distance to self is always 0; no next hop needed
+        cur[i * N + i] = 0;
+        // Direct neighbor: set distance to direct cost and next hop to neighbor
+        for (const Edge* e = graph.begin(i); e != graph.end(i); ++e) {
+            cur[i * N + e->to] = e->cost;
+            nextHop[i * N + e->to] = e->to;
+        }
     }
-} while(updated); // Repeat until no updates are made (convergence)
+    next = cur;
 
-   
+    WorkStealingPool pool(threads);
+    vector<vector<int>> sources(n);   // the k to relax row i through this round
+    vector<char> rowChanged(n, 1), changedNow(n);
+    bool firstRound = true, updated;
+    int rounds = 0;
+    do {
+        ++rounds;
+        pool.run((n + ROW_BLOCK - 1) / ROW_BLOCK, [&](int, int block) {
+            int first = block * ROW_BLOCK, last = min(n, first + ROW_BLOCK);
+            for (int i = first; i < last; ++i) {
+                const T* oldRow = &cur[i * N];
+                const T* staleRow = &next[i * N];  // row i two rounds ago
+                sources[i].clear();
+                for (int k = 0; k < n; ++k) {
+                    if (k == i || oldRow[k] == inf) continue; // Skip self and unreachable
+                    if (firstRound || rowChanged[k] || (rowChanged[i] && oldRow[k] != staleRow[k]))
+                        sources[i].push_back(k);
+                }
+                // The buffer being written still lags behind rows that
+                // changed last round; bring it up to date before relaxing.
+                if (rowChanged[i]) copy(oldRow, oldRow + N, &next[i * N]);
+                changedNow[i] = 0;
+            }
+            // k ascends for every row, which keeps the first-k tie-break,
+            // and each row k tile is loaded once for the whole block.
+            int pending[ROW_BLOCK];
+            for (int j0 = 0; j0 < n; j0 += TILE) {
+                int len = min(TILE, n - j0);
+                fill(pending, pending + ROW_BLOCK, 0);
+                for (int k = 0; k < n; ++k) {
+                    for (int i = first; i < last; ++i) {
+                        int& p = pending[i - first];
+                        if (p == (int)sources[i].size() || sources[i][p] != k) continue;
+                        ++p;
+                        if (relaxTile(&cur[k * N + j0], cur[i * N + k], k,
+                                      &next[i * N + j0], &nextHop[i * N + j0], len))
+                            changedNow[i] = 1;
+                    }
+                }
+            }
+        });
+
+        rowChanged.swap(changedNow);
+        cur.swap(next);
+        firstRound = false;
+        updated = find(rowChanged.begin(), rowChanged.end(), 1) != rowChanged.end();
+    } while (updated); // Repeat until no updates are made (convergence)
+
+    dist.swap(cur);
+    return rounds;
+}
+
+const int32_t NARROW_INF = numeric_limits<int32_t>::max() / 4;
+
+// True if no path can reach the 32-bit infinity.
+bool dvrFitsNarrow(const CSRGraph& graph) {
+    return (Cost)max(graph.n - 1, 0) * maxLinkCost(graph) < NARROW_INF;
+}
+
+// Peak bytes per table entry of computeDVR: two cost buffers, the next
+// hops and the per-row lists of k (up to n ints each in the first rounds).
+// A 32-bit run ends holding its own costs next to the widened copy.
+int dvrEntryBytes(const CSRGraph& graph) {
+    return dvrFitsNarrow(graph) ? 4 + 4 + 4 + 4 : 8 + 8 + 4 + 4;
+}
+
+// Runs the kernel on 32-bit costs when no path can reach the 32-bit
+// infinity, which puts twice as many costs in a vector and halves the
+// memory traffic, and on 64-bit costs otherwise. Returns the round count.
+int computeDVR(const CSRGraph& graph, int threads, vector<Cost>& dist, vector<int>& nextHop) {
+    if (!dvrFitsNarrow(graph))
+        return minPlusRounds(graph, threads, INF, dist, nextHop);
+    vector<int32_t> narrow;
+    int rounds = minPlusRounds(graph, threads, NARROW_INF, narrow, nextHop);
+    dist.resize(narrow.size());
+    for (size_t i = 0; i < narrow.size(); ++i) dist[i] = narrow[i] == NARROW_INF ? INF : narrow[i];
+    return rounds;
+}
+
+// DVR, async DV and incremental updates keep n x n tables. Rather than
+// failing an allocation halfway, a mode whose tables cannot fit in physical
+// memory is refused up front; LSR alone (--lsr-only) stays O(n + m).
+void requireDenseTables(int n, int bytesPerEntry, const string& mode) {
+    long pages = sysconf(_SC_PHYS_PAGES), pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) return;
+    double need = (double)n * n * bytesPerEntry, have = (double)pages * pageSize;
+    if (need <= have) return;
+    cerr << "Error: " << mode << " keeps n x n tables, " << fixed << setprecision(1) << need / (1 << 30)
+         << " GiB for " << n << " nodes, but the machine has " << have / (1 << 30)
+         << " GiB of memory; use --lsr-only for large networks" << endl;
+    exit(1);
+}
+
+// Bytes per table entry of the other dense modes (cost and next-hop tables
+// plus their working copies); DVR depends on the kernel (dvrEntryBytes).
+const int ASYNC_DV_ENTRY_BYTES = 17, UPDATES_ENTRY_BYTES = 36;
+
+void simulateDVR(const CSRGraph& graph, int threads, TableOutput& out) {
+    size_t n = graph.n;
+    vector<Cost> dist;
+    vector<int> nextHop;
+    computeDVR(graph, threads, dist, nextHop);
 
     cout << "--- DVR Final Tables ---\n";
-    for (int i = 0; i < n; ++i) printDVRTable(i, dist, nextHop);
+    for (size_t i = 0; i < n; ++i) out.table(TableKind::DVR, i, &dist[i * n], &nextHop[i * n]);
+    out.flush();
+}
+
+// Incoming links: edge (v -> u, cost) of graph becomes edge (u -> v, cost).
+CSRGraph reverseGraph(const CSRGraph& graph) {
+    CSRGraph rev;
+    rev.n = graph.n;
+    rev.offset.assign(graph.n + 1, 0);
+    for (const Edge& e : graph.edges) ++rev.offset[e.to + 1];
+    for (int u = 0; u < graph.n; ++u) rev.offset[u + 1] += rev.offset[u];
+    rev.edges.resize(graph.edges.size());
+    vector<size_t> fill(rev.offset.begin(), rev.offset.end() - 1);
+    for (int v = 0; v < graph.n; ++v)
+        for (const Edge* e = graph.begin(v); e != graph.end(v); ++e)
+            rev.edges[fill[e->to]++] = {v, e->cost};
+    return rev;
+}
+
+// A change of the cost of the undirected link u - v; NO_LINK takes it down.
+struct LinkUpdate {
+    int u, v, cost;
+};
+
+// A link change of an asynchronous DV run, applied at the start of a tick.
+struct LinkEvent {
+    long long tick;
+    LinkUpdate change;
+};
+
+// Sets the cost of the directed link u -> v, inserting or removing it as
+// needed, and returns the previous cost (NO_LINK if there was no link).
+// Inserting or removing shifts the edge array, so it costs O(n + m).
+int setLinkCost(CSRGraph& graph, int u, int v, int cost) {
+    auto first = graph.edges.begin() + graph.offset[u];
+    auto last = graph.edges.begin() + graph.offset[u + 1];
+    auto it = lower_bound(first, last, v, [](const Edge& e, int to) { return e.to < to; });
+    bool present = it != last && it->to == v;
+    int old = present ? it->cost : NO_LINK;
+    if (present && cost != NO_LINK) {
+        it->cost = cost;
+    } else if (present) {
+        graph.edges.erase(it);
+        for (int w = u + 1; w <= graph.n; ++w) --graph.offset[w];
+    } else if (cost != NO_LINK) {
+        graph.edges.insert(it, {v, cost});
+        for (int w = u + 1; w <= graph.n; ++w) ++graph.offset[w];
+    }
+    return old;
 }
 
-void printLSRTable(int src, const vector<int>& dist, const vector<int>& prev) {
-    cout << "Node " << src << " Routing Table:\n";
-    cout << "Dest\tCost\tNext Hop\n";
-    for (int i = 0; i < dist.size(); ++i) {
-        if (i == src) continue;
-        cout << i << "\t" << dist[i] << "\t";
-        int hop = i;
-        while (prev[hop] != src && prev[hop] != -1)
-            hop = prev[hop];
-        cout << (prev[hop] == -1 ? -1 : hop) << endl;
+// Distance vectors cannot count to infinity over 0-cost loops: a stale route
+// that circles one never gets dearer. Modes with link changes need every
+// link to cost at least 1.
+void requirePositiveLinks(const CSRGraph& graph, const string& mode) {
+    for (const Edge& e : graph.edges) {
+        if (e.cost == 0) {
+            cerr << "Error: " << mode << " needs link costs of at least 1, the input has a 0-cost link" << endl;
+            exit(1);
+        }
+    }
+}
+
+// One routing table entry: the cost to a destination and the next hop
+// towards it (-1 if there is none).
+struct Route {
+    Cost cost;
+    int hop;
+};
+
+enum class LoopPrevention { None, SplitHorizon, PoisonReverse };
+
+// Distance-vector protocols need a finite infinity to stop counting. No
+// loop-free path costs more than n - 1 times the largest link cost, so a
+// route at or above this bound can only be a stale loop and is dropped.
+Cost dvInfinity(int n, int maxLinkCost) {
+    return (Cost)max(n - 1, 1) * max(maxLinkCost, 1) + 1;
+}
+
+/*
+ * Event-driven, asynchronous Distance Vector protocol. Every node is an
+ * actor that only sees its own table and the vectors its neighbours send
+ * it; a message from u to v is delivered after the delay of the link.
+ *
+ * Updates are triggered: when routes of a node change, the changed entries
+ * are sent to all neighbours at the end of the current tick (changes made
+ * within one tick are coalesced into one message per neighbour). A route
+ * learned from neighbour v is either left out of the update sent back to v
+ * (split horizon) or advertised to v as INF (poison reverse). Routes that
+ * reach dvInfinity become unreachable.
+ *
+ * Links can come up, go down or change cost at given ticks. The two ends
+ * then move the routes they had through the link to its new cost (or drop
+ * them), take the link itself if it is now the better route, and ask every
+ * neighbour for its whole table. Nodes keep no copies of their neighbours'
+ * vectors, so a node whose route got worse through its next hop likewise
+ * asks its neighbours for their routes to those destinations. Answers are
+ * sent at once and arrive after one link delay. Old routes of neighbours
+ * are believed, so without split horizon or poison reverse a failure makes
+ * nodes count to infinity. Messages in flight over a link that went down
+ * are lost; the others see the link's current cost, and a link never lets
+ * a message overtake an earlier one even when its delay drops.
+ *
+ * Events are kept in a timing wheel with one slot per tick, covering the
+ * next wheel.size() ticks (enough for every link delay, up to MAX_SLOTS).
+ * Events further away wait in a heap ordered by (tick, send order) and
+ * move into the wheel as their tick comes within range, before anything
+ * else can be scheduled for it, so each tick still delivers in send order.
+ * When the wheel is empty the clock jumps to the next event, so time and
+ * memory depend on the number of events, not on the size of the delays.
+ * The changed routes of one update are stored once, in a pooled
+ * snapshot shared by the messages to all neighbours (each receiver applies
+ * split horizon or poison reverse to its own copy of the view); snapshots
+ * and wheel slots are recycled, so steady state allocates nothing.
+ */
+class AsyncDVSimulator {
+public:
+    struct Stats {
+        long long convergenceTime = 0; // tick of the last route change
+        long long messages = 0;
+        long long routeEntries = 0;    // (dest, cost) pairs carried by all messages
+        long long events = 0;
+        long long linkChanges = 0;
+        long long lastLinkChange = 0;  // tick of the last link change
+        double seconds = 0;
+    };
+
+    // fixedDelay > 0 gives every link that delay; otherwise a link's delay
+    // is its cost (at least one tick). The link events are applied to graph,
+    // which ends up holding the final topology.
+    AsyncDVSimulator(CSRGraph& graph, int fixedDelay, LoopPrevention policy, const vector<LinkEvent>& linkEvents = {})
+        : graph(graph), incoming(reverseGraph(graph)), n(graph.n), fixedDelay(fixedDelay), policy(policy),
+          routes((size_t)n * n, {INF, -1}), pendingDest((size_t)n * n, 0), changedDests(n), nodeDirty(n, 0),
+          viaCount(n, 0), linkEvents(linkEvents), requestedDests(n) {
+        int maxCost = maxLinkCost(graph);
+        for (const LinkEvent& ev : linkEvents)
+            if (ev.change.cost != NO_LINK) maxCost = max(maxCost, ev.change.cost);
+        infinity = dvInfinity(n, maxCost);
+        int maxDelay = delayOf(maxCost);
+        size_t slots = 1;
+        while (slots <= (size_t)maxDelay && slots < MAX_SLOTS) slots <<= 1;
+        wheel.resize(slots);
+    }
+
+    // Routing table of node, one Route per destination.
+    const Route* table(int node) const { return &routes[(size_t)node * n]; }
+
+    Stats run() {
+        auto start = chrono::steady_clock::now();
+        // Every node starts out knowing itself and its direct links.
+        for (int v = 0; v < n; ++v) {
+            setRoute(v, v, 0, -1);
+            for (const Edge* e = graph.begin(v); e != graph.end(v); ++e)
+                setRoute(v, e->to, e->cost, e->to);
+        }
+
+        while (true) {
+            while (nextEvent < linkEvents.size() && linkEvents[nextEvent].tick == now)
+                changeLink(linkEvents[nextEvent++].change);
+            while (!farMessages.empty() && farMessages.top().at - now < (long long)wheel.size()) {
+                wheel[farMessages.top().at & (wheel.size() - 1)].push_back(farMessages.top().msg);
+                farMessages.pop();
+            }
+            vector<Message>& slot = wheel[now & (wheel.size() - 1)];
+            if (linkEvents.empty()) {
+                for (const Message& msg : slot) deliver<false>(msg);
+            } else {
+                for (const Message& msg : slot) deliver<true>(msg);
+            }
+            stats.events += slot.size();
+            inFlight -= slot.size();
+            slot.clear();
+
+            for (int u : dirtyNodes) sendUpdates(u);
+            dirtyNodes.clear();
+            for (int v : requestingNodes) requestRoutes(v);
+            requestingNodes.clear();
+
+            bool eventsLeft = nextEvent < linkEvents.size();
+            if (inFlight == 0 && !eventsLeft) break;
+            if (inFlight == (long long)farMessages.size()) {
+                // Nothing in the wheel: jump to the next message or link event
+                long long next = eventsLeft ? linkEvents[nextEvent].tick : numeric_limits<long long>::max();
+                if (!farMessages.empty()) next = min(next, farMessages.top().at);
+                now = next;
+            } else {
+                ++now;
+            }
+        }
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+private:
+    // A route of the sender as it stood when the update was sent.
+    struct Advert {
+        int dest;
+        int hop;
+        Cost cost;
+    };
+
+    struct Message {
+        int from, to;
+        int linkCost; // cost of the receiver's link to the sender
+        int snapshot;
+    };
+
+    // A message due beyond the range of the wheel.
+    struct FarMessage {
+        long long at, seq;
+        Message msg;
+        bool operator>(const FarMessage& o) const { return at != o.at ? at > o.at : seq > o.seq; }
+    };
+
+    static const size_t MAX_SLOTS = 4096;
+
+    int delayOf(int cost) const { return fixedDelay > 0 ? fixedDelay : max(cost, 1); }
+
+    void setRoute(int v, int dest, Cost cost, int hop) {
+        size_t idx = (size_t)v * n + dest;
+        routes[idx] = {cost, hop};
+        stats.convergenceTime = now;
+        if (!pendingDest[idx]) {
+            pendingDest[idx] = 1;
+            changedDests[v].push_back(dest);
+        }
+        if (!nodeDirty[v]) {
+            nodeDirty[v] = 1;
+            dirtyNodes.push_back(v);
+        }
+    }
+
+    // Current cost of the link v -> u, NO_LINK if it is down.
+    int linkCost(int v, int u) const {
+        const Edge* first = graph.begin(v);
+        const Edge* last = graph.end(v);
+        const Edge* it = lower_bound(first, last, u, [](const Edge& e, int to) { return e.to < to; });
+        return it != last && it->to == u ? it->cost : NO_LINK;
+    }
+
+    // Static runs skip the link lookup and route requests, which keeps the
+    // hot loop as small as it was before link events existed.
+    template <bool LinksChange>
+    void deliver(const Message& msg) {
+        int v = msg.to, u = msg.from;
+        int viaCost = msg.linkCost;
+        if (LinksChange) {
+            viaCost = linkCost(v, u);
+            if (viaCost == NO_LINK) { // lost with the link
+                release(msg.snapshot);
+                return;
+            }
+        }
+        Route* row = &routes[(size_t)v * n];
+        for (const Advert& a : snapshots[msg.snapshot]) {
+            if (a.dest == v) continue;
+            Cost advertised = a.cost;
+            if (a.hop == v) {
+                // A route left out by split horizon is dropped by a receiver
+                // that still used it, standing in for a real protocol's
+                // route timeout; otherwise it is ignored.
+                if (policy == LoopPrevention::SplitHorizon && row[a.dest].hop != u) continue;
+                if (policy != LoopPrevention::None) advertised = INF;
+            }
+            Cost cost = viaCost + advertised;
+            if (cost >= infinity) cost = INF;
+            Route& r = row[a.dest];
+            if (r.hop == u) {
+                // The current next hop is always believed, even when its
+                // route got worse; this is how bad news spreads (and how
+                // counting to infinity happens without poison reverse).
+                if (LinksChange && cost > r.cost) requestRoute(v, a.dest);
+                if (cost != r.cost) setRoute(v, a.dest, cost, cost == INF ? -1 : u);
+            } else if (cost < r.cost) {
+                setRoute(v, a.dest, cost, u);
+            }
+        }
+        release(msg.snapshot);
+    }
+
+    void release(int snapshot) {
+        if (--snapshotRefs[snapshot] == 0) freeSnapshots.push_back(snapshot);
+    }
+
+    int newSnapshot() {
+        if (freeSnapshots.empty()) {
+            snapshots.emplace_back();
+            snapshotRefs.push_back(0);
+            return snapshots.size() - 1;
+        }
+        int id = freeSnapshots.back();
+        freeSnapshots.pop_back();
+        snapshots[id].clear();
+        return id;
+    }
+
+    // Sends snapshot from u to v, which receives it over its link of cost
+    // linkCost to u; entries is the number of routes v actually gets.
+    void send(int u, int v, int linkCost, int snapshot, long long entries) {
+        long long at = now + delayOf(linkCost);
+        if (!linkEvents.empty()) {
+            // Delays change with link costs; keep every link first in, first out
+            long long& last = lastArrival[(long long)u * n + v];
+            at = last = max(at, last);
+        }
+        if (at - now < (long long)wheel.size())
+            wheel[at & (wheel.size() - 1)].push_back({u, v, linkCost, snapshot});
+        else
+            farMessages.push({at, farSeq++, {u, v, linkCost, snapshot}});
+        ++snapshotRefs[snapshot];
+        ++inFlight;
+        ++stats.messages;
+        stats.routeEntries += entries;
+    }
+
+    // Node u answers a request of v with its reachable routes to dests (to
+    // every destination if dests is null).
+    void sendRoutes(int u, int v, int linkCost, const vector<int>* dests) {
+        int id = newSnapshot();
+        vector<Advert>& snap = snapshots[id];
+        const Route* row = &routes[(size_t)u * n];
+        long long entries = 0;
+        for (int k = 0, count = dests ? dests->size() : n; k < count; ++k) {
+            int dest = dests ? (*dests)[k] : k;
+            if (row[dest].cost == INF) continue;
+            snap.push_back({dest, row[dest].hop, row[dest].cost});
+            if (policy != LoopPrevention::SplitHorizon || row[dest].hop != v) ++entries;
+        }
+        if (!snap.empty()) send(u, v, linkCost, id, entries); // left-out routes are withdrawn
+        if (snapshotRefs[id] == 0) freeSnapshots.push_back(id);
+    }
+
+    void requestRoute(int v, int dest) {
+        if (requestedDests[v].empty()) requestingNodes.push_back(v);
+        requestedDests[v].push_back(dest);
+    }
+
+    // Asks every neighbour of v for its routes to the destinations that got
+    // worse at v this tick.
+    void requestRoutes(int v) {
+        vector<int>& dests = requestedDests[v];
+        sort(dests.begin(), dests.end());
+        dests.erase(unique(dests.begin(), dests.end()), dests.end());
+        for (const Edge* e = graph.begin(v); e != graph.end(v); ++e) sendRoutes(e->to, v, e->cost, &dests);
+        dests.clear();
+    }
+
+    // Applies a change of the link u - v to both of its ends.
+    void changeLink(const LinkUpdate& change) {
+        ++stats.linkChanges;
+        stats.lastLinkChange = now;
+        for (int dir = 0; dir < 2; ++dir) {
+            int a = dir ? change.v : change.u, b = dir ? change.u : change.v;
+            int old = setLinkCost(graph, a, b, change.cost);
+            setLinkCost(incoming, b, a, change.cost);
+            if (old == change.cost) continue;
+            Route* row = &routes[(size_t)a * n];
+            for (int dest = 0; dest < n; ++dest) {
+                if (row[dest].hop != b) continue;
+                Cost cost = change.cost == NO_LINK ? INF : row[dest].cost - old + change.cost;
+                if (cost >= infinity) cost = INF;
+                setRoute(a, dest, cost, cost == INF ? -1 : b);
+            }
+            if (change.cost != NO_LINK && change.cost < row[b].cost) setRoute(a, b, change.cost, b);
+            for (const Edge* e = graph.begin(a); e != graph.end(a); ++e) sendRoutes(e->to, a, e->cost, nullptr);
+        }
+    }
+
+    // Sends the routes of u that changed since its last update to every
+    // node that has a link to u.
+    void sendUpdates(int u) {
+        nodeDirty[u] = 0;
+        int id = newSnapshot();
+        vector<Advert>& snap = snapshots[id];
+        for (int dest : changedDests[u]) {
+            size_t idx = (size_t)u * n + dest;
+            pendingDest[idx] = 0;
+            snap.push_back({dest, routes[idx].hop, routes[idx].cost});
+            if (routes[idx].hop >= 0) ++viaCount[routes[idx].hop];
+        }
+        changedDests[u].clear();
+
+        for (const Edge* e = incoming.begin(u); e != incoming.end(u); ++e) {
+            int v = e->to;
+            long long entries = snap.size();
+            if (policy == LoopPrevention::SplitHorizon) entries -= viaCount[v];
+            // Once links change, an update whose routes were all left out
+            // still goes: it withdraws them from a receiver that used them.
+            if (entries > 0 || (!linkEvents.empty() && !snap.empty())) send(u, v, e->cost, id, entries);
+        }
+        for (const Advert& a : snap)
+            if (a.hop >= 0) viaCount[a.hop] = 0;
+        if (snapshotRefs[id] == 0) freeSnapshots.push_back(id);
     }
-    cout << endl;
+
+    CSRGraph& graph;
+    CSRGraph incoming; // who receives u's updates, and their link cost to u
+    int n;
+    int fixedDelay;
+    LoopPrevention policy;
+    Cost infinity;
+
+    vector<Route> routes;          // n x n, row v is node v's routing table
+    vector<char> pendingDest;      // n x n, entry changed since the node's last update
+    vector<vector<int>> changedDests;
+    vector<char> nodeDirty;
+    vector<int> dirtyNodes;
+    vector<int> viaCount;          // per neighbour, routes of the update learned from it
+
+    vector<vector<Advert>> snapshots;
+    vector<int> snapshotRefs;      // messages still carrying each snapshot
+    vector<int> freeSnapshots;
+
+    vector<LinkEvent> linkEvents;  // in tick order
+    size_t nextEvent = 0;
+    vector<vector<int>> requestedDests; // per node, routes that got worse this tick
+    vector<int> requestingNodes;
+    unordered_map<long long, long long> lastArrival; // per directed link u * n + v
+
+    vector<vector<Message>> wheel;
+    priority_queue<FarMessage, vector<FarMessage>, greater<FarMessage>> farMessages;
+    long long farSeq = 0;
+    long long now = 0;
+    long long inFlight = 0;
+    Stats stats;
+};
+
+void simulateAsyncDV(CSRGraph& graph, int fixedDelay, LoopPrevention policy, const vector<LinkEvent>& linkEvents,
+                     TableOutput& out) {
+    AsyncDVSimulator sim(graph, fixedDelay, policy, linkEvents);
+    AsyncDVSimulator::Stats stats = sim.run();
+
+    cout << "--- Async DV Final Tables ---\n";
+    vector<Cost> dist(graph.n);
+    vector<int> nextHop(graph.n);
+    for (int i = 0; i < graph.n; ++i) {
+        const Route* row = sim.table(i);
+        for (int j = 0; j < graph.n; ++j) {
+            dist[j] = row[j].cost;
+            nextHop[j] = row[j].hop;
+        }
+        out.table(TableKind::AsyncDV, i, dist.data(), nextHop.data());
+    }
+    out.flush();
+
+    cout << "Convergence time: " << stats.convergenceTime << " ticks\n";
+    if (stats.linkChanges > 0) {
+        cout << "Link changes: " << stats.linkChanges << ", the last at tick " << stats.lastLinkChange
+             << "; routes settled " << max(stats.convergenceTime - stats.lastLinkChange, 0LL) << " ticks later\n";
+    }
+    cout << "Messages: " << stats.messages << " (" << stats.routeEntries << " route entries)\n";
+    double seconds = max(stats.seconds, 1e-9);
+    cout << "Events: " << stats.events << " in " << fixed << setprecision(3) << stats.seconds << " s ("
+         << setprecision(0) << stats.events / seconds << " events/s, "
+         << stats.routeEntries / seconds << " route entries/s)\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
 }
 
-void simulateLSR(const vector<vector<int>>& graph) {
-    int n = graph.size();
-    for (int src = 0; src < n; ++src) {
-        vector<int> dist(n, INF);
-        vector<int> prev(n, -1);
-        vector<bool> visited(n, false);
-        dist[src] = 0;
-        
-         //TODO: Complete this
-         // Create a min-heap priority queue to select the node with the smallest distance
-priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> pq;
+/*
+ * 4-ary indexed min-heap over node ids with decrease-key. Nodes are ordered
+ * by (dist[v], v): the id tie-break settles equal-cost nodes in the same
+ * order as a priority_queue of (dist, node) pairs, so the chosen shortest
+ * paths do not depend on the heap implementation.
+ */
+class IndexedHeap {
+public:
+    // Every pop clears its pos entry, so a drained heap is reused for the
+    // next search without an O(n) reset.
+    void reset(int n, const Cost* distRow) {
+        dist = distRow;
+        heap.clear();
+        if ((int)pos.size() != n) pos.assign(n, -1);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    void pushOrDecrease(int v) {
+        if (pos[v] < 0) {
+            pos[v] = heap.size();
+            heap.push_back(v);
+        }
+        siftUp(pos[v]);
+    }
+
+    int pop() {
+        int top = heap[0];
+        pos[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    bool less(int a, int b) const {
+        return dist[a] < dist[b] || (dist[a] == dist[b] && a < b);
+    }
 
-// Start from the source node with distance 0
-pq.push({0, src});
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 4;
+            if (!less(v, heap[parent])) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
 
-while(!pq.empty()) {
-    // Get the node u with the smallest current distance (cur_dist)
-    auto [cur_dist, u] = pq.top();
-    pq.pop();
-    
-    // If node u has already been visited, skip it
-    if(visited[u]) continue;
-    visited[u] = true; // Mark node u as visited
+    void siftDown(int i) {
+        int v = heap[i];
+        int size = heap.size();
+        while (true) {
+            int first = 4 * i + 1;
+            if (first >= size) break;
+            int best = first;
+            for (int c = first + 1; c < min(first + 4, size); ++c)
+                if (less(heap[c], heap[best])) best = c;
+            if (!less(heap[best], v)) break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
 
-    // For every possible neighbor v of node u
-    for(int v=0; v<n; ++v) {
-        // Skip self-loops and unreachable neighbors
-        if(v == u || graph[u][v] == INF) continue;
-        
-        // Calculate the new distance to v via u
-        int new_dist = cur_dist + graph[u][v];
+    const Cost* dist = nullptr;
+    vector<int> heap;
+    vector<int> pos;
+};
 
-        // If this path is shorter, update the distance and predecessor
-        if(new_dist < dist[v]) {
-            dist[v] = new_dist; // Update shortest distance to v
-            prev[v] = u;        // Set u as the predecessor of v
-            pq.push({new_dist, v}); // Add v to the priority queue with updated distance
+/*
+ * Dijkstra from src, writing the cost and the first hop towards every
+ * destination straight into the caller's table rows. The next hop of v is
+ * inherited from its predecessor u when the edge (u, v) is relaxed (or is v
+ * itself when u is the source), so no predecessor chains are walked later.
+ * The predecessors themselves are only recorded if parent is given.
+ */
+void dijkstraNextHops(const CSRGraph& graph, int src, IndexedHeap& heap, Cost* dist, int* nextHop,
+                      int* parent = nullptr) {
+    fill(dist, dist + graph.n, INF);
+    fill(nextHop, nextHop + graph.n, -1);
+    if (parent) fill(parent, parent + graph.n, -1);
+    dist[src] = 0;
+    heap.reset(graph.n, dist);
+    heap.pushOrDecrease(src);
+
+    while (!heap.empty()) {
+        int u = heap.pop();
+        for (const Edge* e = graph.begin(u); e != graph.end(u); ++e) {
+            int v = e->to;
+            Cost new_dist = dist[u] + e->cost;
+            if (new_dist < dist[v]) {
+                dist[v] = new_dist;
+                nextHop[v] = (u == src) ? v : nextHop[u];
+                if (parent) parent[v] = u;
+                heap.pushOrDecrease(v);
+            }
         }
     }
 }
 
-        
-        printLSRTable(src, dist, prev);
+/*
+ * Computes the link-state routing tables of the given sources on a pool of
+ * threads. Sources are solved a block at a time so the tables waiting to be
+ * consumed stay bounded (about 16M entries) regardless of n; onBlock gets
+ * the rows of sources[first .. first + rows), each n entries long. Every
+ * worker reuses its own heap across sources.
+ */
+void forEachLSRBlock(const CSRGraph& graph, const vector<int>& sources, int threads,
+                     const function<void(int, int, const Cost*, const int*)>& onBlock) {
+    size_t n = graph.n;
+    int count = sources.size();
+    // No more workers than sources, and rows for at most count sources, so
+    // a few sources on a huge graph cost O(n) memory whatever the threads.
+    WorkStealingPool pool(min(threads, max(count, 1)));
+    vector<IndexedHeap> heaps(pool.size());
+
+    int block = min(count, max(pool.size(), (1 << 24) / max(graph.n, 1)));
+    vector<Cost> dist(block * n);
+    vector<int> nextHop(block * n);
+
+    for (int first = 0; first < count; first += block) {
+        int rows = min(block, count - first);
+        pool.run(rows, [&](int worker, int r) {
+            dijkstraNextHops(graph, sources[first + r], heaps[worker], dist.data() + r * n, nextHop.data() + r * n);
+        });
+        onBlock(first, rows, dist.data(), nextHop.data());
     }
 }
 
-vector<vector<int>> readGraphFromFile(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Could not open file " << filename << endl;
+// Only the selected sources are computed.
+void simulateLSR(const CSRGraph& graph, int threads, TableOutput& out) {
+    size_t n = graph.n;
+    const vector<int>& sources = out.nodes();
+    forEachLSRBlock(graph, sources, threads, [&](int first, int rows, const Cost* dist, const int* nextHop) {
+        for (int r = 0; r < rows; ++r)
+            out.table(TableKind::LSR, sources[first + r], dist + r * n, nextHop + r * n);
+    });
+    out.flush();
+}
+
+/*
+ * Read-only memory mapping of an input file. The parser below walks the
+ * mapped bytes directly, which avoids the per-token overhead of ifstream
+ * and lets the kernel read ahead on large topology files.
+ */
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    explicit MappedFile(const string& filename) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            cerr << "Error: Could not open file " << filename << endl;
+            exit(1);
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            size = st.st_size;
+            void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                cerr << "Error: Could not map file " << filename << ": " << strerror(errno) << endl;
+                exit(1);
+            }
+            madvise(p, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(p);
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+// Hand-written integer scanner over the mapped bytes.
+struct IntScanner {
+    const char* begin;
+    const char* p;
+    const char* end;
+    string filename;
+
+    IntScanner(const MappedFile& file, const string& name)
+        : begin(file.data), p(file.data), end(file.data + file.size), filename(name) {}
+
+    [[noreturn]] void fail(const string& what) const {
+        cerr << "Error: " << what << " in " << filename << " at byte " << (p - begin) << endl;
         exit(1);
     }
-    
+
+    bool atEnd() {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+        return p == end;
+    }
+
+    // True if another token follows on the current line.
+    bool moreOnLine() {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p != end && *p != '\n';
+    }
+
+    long long next() {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+        bool negative = p != end && *p == '-';
+        if (negative) ++p;
+        if (p == end || *p < '0' || *p > '9')
+            fail(p == end ? "Unexpected end of file" : "Expected an integer");
+        long long value = 0;
+        while (p != end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p++ - '0');
+            if (value > numeric_limits<int>::max()) fail("Integer out of range");
+        }
+        return negative ? -value : value;
+    }
+
+    int nextNode(int n) {
+        long long v = next();
+        if (v < 0 || v >= n) fail("Node id out of range");
+        return v;
+    }
+
+    int nextCost() {
+        long long c = next();
+        if (c < 0) fail("Negative link cost");
+        return c;
+    }
+};
+
+// Sorts each node's links by destination and keeps the cheapest of any
+// parallel links, compacting the edge array in place.
+void normalizeCSR(CSRGraph& graph) {
+    size_t out = 0;
+    for (int u = 0; u < graph.n; ++u) {
+        auto first = graph.edges.begin() + graph.offset[u];
+        auto last = graph.edges.begin() + graph.offset[u + 1];
+        sort(first, last, [](const Edge& a, const Edge& b) {
+            return a.to != b.to ? a.to < b.to : a.cost < b.cost;
+        });
+        graph.offset[u] = out;
+        for (auto e = first; e != last; ++e)
+            if (e == first || e->to != (e - 1)->to) graph.edges[out++] = *e;
+    }
+    graph.offset[graph.n] = out;
+    graph.edges.resize(out);
+    graph.edges.shrink_to_fit();
+}
+
+// Links of an edge-list file are parsed a batch at a time, so the scattered
+// degree and fill updates for a batch run back to back and their cache
+// misses overlap instead of each one stalling the parser.
+struct EdgeBatch {
+    static const int CAPACITY = 512;
+    int size = 0;
+    int u[CAPACITY], v[CAPACITY], cost[CAPACITY];
+
+    // Reads up to CAPACITY links, dropping self-loops and NO_LINK links.
+    bool read(IntScanner& in, int n, long long& remaining) {
+        size = 0;
+        for (; size < CAPACITY && remaining > 0; --remaining) {
+            u[size] = in.nextNode(n);
+            v[size] = in.nextNode(n);
+            cost[size] = in.nextCost();
+            if (u[size] != v[size] && cost[size] != NO_LINK) ++size;
+        }
+        return size > 0 || remaining > 0;
+    }
+};
+
+/*
+ * Two input formats are accepted:
+ *   - Adjacency matrix: n on the first line, then n rows of n costs
+ *     (NO_LINK = 9999 for no link).
+ *   - Edge list: "n m" on the first line, then m lines "u v cost", each an
+ *     undirected link. Parallel links keep the cheapest cost.
+ * The edge list is scanned twice (degree count, then fill) so the graph is
+ * built straight into its CSR arrays without an intermediate edge buffer.
+ */
+CSRGraph readGraphFromFile(const string& filename) {
+    MappedFile file(filename);
+    IntScanner in(file, filename);
+    CSRGraph graph;
+
+    long long n = in.next();
+    if (n < 0) in.fail("Negative node count");
+    graph.n = n;
+    graph.offset.assign(n + 1, 0);
+
+    if (in.moreOnLine()) {
+        long long m = in.next();
+        const char* edgesStart = in.p;
+        EdgeBatch batch;
+
+        long long remaining = m;
+        while (batch.read(in, n, remaining)) {
+            for (int k = 0; k < batch.size; ++k) {
+                ++graph.offset[batch.u[k] + 1];
+                ++graph.offset[batch.v[k] + 1];
+            }
+        }
+        for (int u = 0; u < n; ++u) graph.offset[u + 1] += graph.offset[u];
+
+        graph.edges.resize(graph.offset[n]);
+        vector<size_t> fill(graph.offset.begin(), graph.offset.end() - 1);
+        in.p = edgesStart;
+        remaining = m;
+        while (batch.read(in, n, remaining)) {
+            for (int k = 0; k < batch.size; ++k) {
+                graph.edges[fill[batch.u[k]]++] = {batch.v[k], batch.cost[k]};
+                graph.edges[fill[batch.v[k]]++] = {batch.u[k], batch.cost[k]};
+            }
+        }
+        normalizeCSR(graph);
+    } else {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                int cost = in.nextCost();
+                if (i != j && cost != NO_LINK) graph.edges.push_back({j, cost});
+            }
+            graph.offset[i + 1] = graph.edges.size();
+        }
+    }
+    return graph;
+}
+
+// Update stream: one "u v cost" line per link change, applied in order.
+vector<LinkUpdate> readUpdatesFromFile(const string& filename, int n) {
+    MappedFile file(filename);
+    IntScanner in(file, filename);
+    vector<LinkUpdate> updates;
+    while (!in.atEnd()) {
+        int u = in.nextNode(n), v = in.nextNode(n), cost = in.nextCost();
+        if (u == v) in.fail("Self-loop update");
+        if (cost == 0) in.fail("0-cost link (not supported with --updates)");
+        updates.push_back({u, v, cost});
+    }
+    return updates;
+}
+
+// Link events of an async DV run: one "tick u v cost" line per change.
+// Events are applied in tick order, those of one tick in file order.
+vector<LinkEvent> readLinkEventsFromFile(const string& filename, int n) {
+    MappedFile file(filename);
+    IntScanner in(file, filename);
+    vector<LinkEvent> events;
+    while (!in.atEnd()) {
+        long long tick = in.next();
+        if (tick < 0) in.fail("Negative tick");
+        int u = in.nextNode(n), v = in.nextNode(n), cost = in.nextCost();
+        if (u == v) in.fail("Self-loop link event");
+        if (cost == 0) in.fail("0-cost link (not supported with --events)");
+        events.push_back({tick, {u, v, cost}});
+    }
+    stable_sort(events.begin(), events.end(),
+                [](const LinkEvent& a, const LinkEvent& b) { return a.tick < b.tick; });
+    return events;
+}
+
+/*
+ * Link-state routing tables that are repaired after a link change instead
+ * of being recomputed (dynamic SSSP in the style of Ramalingam and Reps).
+ * Every source keeps its shortest-path tree as a parent array next to the
+ * cost and next-hop rows. When the cost of u -> v changes, each source:
+ *   - on a decrease, relaxes v through u and, if that helps, continues
+ *     Dijkstra from v over the nodes that improve;
+ *   - on an increase, does nothing unless u -> v is a tree edge. Otherwise
+ *     the subtree below v is the set of nodes whose path used the link;
+ *     they are reset, seeded from their unaffected in-neighbours and
+ *     settled with Dijkstra restricted to the subtree.
+ * Sources are repaired in parallel, each worker with its own heap and marks.
+ */
+class IncrementalLSR {
+public:
+    IncrementalLSR(const CSRGraph& graph, const CSRGraph& incoming, int threads)
+        : graph(graph), incoming(incoming), n(graph.n), pool(threads),
+          dist((size_t)n * n), nextHop((size_t)n * n), parent((size_t)n * n),
+          scratch(pool.size()) {}
+
+    const Cost* costs(int src) const { return &dist[(size_t)src * n]; }
+    const int* hops(int src) const { return &nextHop[(size_t)src * n]; }
+
+    // Computes every tree from scratch; returns the number of nodes settled.
+    long long computeAll() {
+        pool.run(n, [&](int worker, int src) {
+            size_t row = (size_t)src * n;
+            dijkstraNextHops(graph, src, scratch[worker].heap, &dist[row], &nextHop[row], &parent[row]);
+            scratch[worker].touched += count_if(&dist[row], &dist[row] + n, [](Cost d) { return d < INF; });
+        });
+        return collectTouched();
+    }
+
+    // Repairs every tree after the cost of u -> v changed from oldCost (the
+    // graph already holds the new cost; NO_LINK if there was no link) and
+    // returns the number of nodes visited. A missing link counts as INF, so
+    // adding a link is a decrease and removing one an increase.
+    long long linkChanged(int u, int v, int oldCost) {
+        Cost before = oldCost == NO_LINK ? INF : oldCost, after = INF;
+        for (const Edge* e = graph.begin(u); e != graph.end(u); ++e)
+            if (e->to == v) after = e->cost;
+        if (after == before) return 0;
+        pool.run(n, [&](int worker, int src) {
+            if (after < before) decreased(scratch[worker], src, u, v, after);
+            else increased(scratch[worker], src, u, v);
+        });
+        return collectTouched();
+    }
+
+private:
+    struct Scratch {
+        IndexedHeap heap;
+        vector<int> mark;      // mark[x] == epoch: x is in the affected subtree
+        int epoch = 0;
+        vector<int> subtree;
+        long long touched = 0;
+    };
+
+    long long collectTouched() {
+        long long total = 0;
+        for (Scratch& s : scratch) {
+            total += s.touched;
+            s.touched = 0;
+        }
+        return total;
+    }
+
+    // Dijkstra continued from the nodes already in the heap; only nodes
+    // accepted by canRelax are improved.
+    template <class CanRelax>
+    void settle(Scratch& s, int src, Cost* d, int* hop, int* par, CanRelax canRelax) {
+        while (!s.heap.empty()) {
+            int x = s.heap.pop();
+            ++s.touched;
+            for (const Edge* e = graph.begin(x); e != graph.end(x); ++e) {
+                int y = e->to;
+                Cost nd = d[x] + e->cost;
+                if (nd < d[y] && canRelax(y)) {
+                    d[y] = nd;
+                    hop[y] = (x == src) ? y : hop[x];
+                    par[y] = x;
+                    s.heap.pushOrDecrease(y);
+                }
+            }
+        }
+    }
+
+    void decreased(Scratch& s, int src, int u, int v, Cost cost) {
+        size_t row = (size_t)src * n;
+        Cost* d = &dist[row];
+        int* hop = &nextHop[row];
+        int* par = &parent[row];
+        if (d[u] == INF || d[u] + cost >= d[v]) return;
+        d[v] = d[u] + cost;
+        hop[v] = (u == src) ? v : hop[u];
+        par[v] = u;
+        s.heap.reset(n, d);
+        s.heap.pushOrDecrease(v);
+        settle(s, src, d, hop, par, [](int) { return true; });
+    }
+
+    void increased(Scratch& s, int src, int u, int v) {
+        size_t row = (size_t)src * n;
+        Cost* d = &dist[row];
+        int* hop = &nextHop[row];
+        int* par = &parent[row];
+        if (par[v] != u) return;
+
+        // Collect the subtree hanging from v: tree edges are graph edges,
+        // so children are found among the out-neighbours.
+        if ((int)s.mark.size() != n) s.mark.assign(n, 0);
+        int epoch = ++s.epoch;
+        s.subtree.assign(1, v);
+        s.mark[v] = epoch;
+        for (size_t i = 0; i < s.subtree.size(); ++i) {
+            int x = s.subtree[i];
+            for (const Edge* e = graph.begin(x); e != graph.end(x); ++e)
+                if (par[e->to] == x && s.mark[e->to] != epoch) {
+                    s.mark[e->to] = epoch;
+                    s.subtree.push_back(e->to);
+                }
+        }
+        for (int x : s.subtree) {
+            d[x] = INF;
+            hop[x] = -1;
+            par[x] = -1;
+        }
+
+        s.heap.reset(n, d);
+        for (int x : s.subtree) {
+            for (const Edge* e = incoming.begin(x); e != incoming.end(x); ++e) {
+                int y = e->to;
+                if (s.mark[y] == epoch || d[y] == INF) continue;
+                Cost nd = d[y] + e->cost;
+                if (nd < d[x]) {
+                    d[x] = nd;
+                    hop[x] = (y == src) ? x : hop[y];
+                    par[x] = y;
+                }
+            }
+            if (d[x] < INF) s.heap.pushOrDecrease(x);
+        }
+        s.touched += s.subtree.size();
+        settle(s, src, d, hop, par, [&](int y) { return s.mark[y] == epoch; });
+    }
+
+    const CSRGraph& graph;
+    const CSRGraph& incoming;
     int n;
-    file >> n;
-    vector<vector<int>> graph(n, vector<int>(n));
+    WorkStealingPool pool;
+    vector<Cost> dist;                 // n x n, row src is the tree of src
+    vector<int> nextHop, parent;
+    vector<Scratch> scratch;
+};
+
+/*
+ * Distance Vector tables maintained by synchronous protocol rounds: in each
+ * round every entry whose inputs changed is recomputed from the vectors
+ * the neighbours held in the previous round,
+ *   D[v][x] = min over links v -> w of cost(v, w) + D[w][x],
+ * so the next hop is always a neighbour. After a link change only the
+ * entries of its endpoints are seeded, and a changed entry D[u][x] only
+ * schedules D[v][x] for the nodes v that link to u.
+ *
+ * Old routes are trusted until replaced, exactly as in the real protocol,
+ * so when a link fails without poison reverse the affected nodes bounce a
+ * stale route between each other and count up to the protocol infinity (or
+ * to the cost of a real alternative) a little every round. Counting only
+ * ends because every lap of such a loop costs more; over 0-cost links a
+ * stale route would circulate forever or stay as a false route, so links
+ * must cost at least 1 (see requirePositiveLinks).
+ */
+class IncrementalDV {
+public:
+    struct RunStats {
+        int rounds = 0;
+        long long recomputed = 0; // entries recomputed over all rounds
+    };
 
-    for (int i = 0; i < n; ++i)
-        for (int j = 0; j < n; ++j)
-            file >> graph[i][j];
+    // Routes costing infinity or more are dropped (see dvInfinity).
+    IncrementalDV(const CSRGraph& graph, const CSRGraph& incoming, LoopPrevention policy, Cost infinity)
+        : graph(graph), incoming(incoming), n(graph.n), policy(policy), infinity(infinity),
+          routes((size_t)n * n), stamp((size_t)n * n, 0) {}
 
-    file.close();
+    const Route* table(int node) const { return &routes[(size_t)node * n]; }
+
+    // Converges from empty tables (every node only knows itself).
+    RunStats computeAll() {
+        fill(routes.begin(), routes.end(), Route{INF, -1});
+        changed.clear();
+        for (int v = 0; v < n; ++v) {
+            routes[(size_t)v * n + v] = {0, -1};
+            changed.push_back((size_t)v * n + v);
+        }
+        candidates.clear();
+        scheduleDependents();
+        return converge();
+    }
+
+    // Re-converges after the cost of a link leaving u changed in the graph.
+    RunStats linkChanged(int u) {
+        candidates.clear();
+        ++round;
+        for (int x = 0; x < n; ++x) schedule((size_t)u * n + x);
+        return converge();
+    }
+
+private:
+    void schedule(size_t idx) {
+        if (idx / n == idx % n || stamp[idx] == round) return; // own entry is fixed
+        stamp[idx] = round;
+        candidates.push_back(idx);
+    }
+
+    // Schedules D[v][x] for every changed D[u][x] and link v -> u.
+    void scheduleDependents() {
+        ++round;
+        for (size_t idx : changed) {
+            int u = idx / n, x = idx % n;
+            for (const Edge* e = incoming.begin(u); e != incoming.end(u); ++e)
+                schedule((size_t)e->to * n + x);
+        }
+    }
+
+    Route recompute(int v, int x) const {
+        Route best{INF, -1};
+        for (const Edge* e = graph.begin(v); e != graph.end(v); ++e) {
+            const Route& adv = routes[(size_t)e->to * n + x];
+            Cost advertised = adv.cost;
+            if (adv.hop == v && policy != LoopPrevention::None) advertised = INF;
+            Cost cost = e->cost + advertised;
+            if (cost < best.cost && cost < infinity) best = {cost, e->to};
+        }
+        return best;
+    }
+
+    RunStats converge() {
+        RunStats stats;
+        vector<Route> next;
+        while (!candidates.empty()) {
+            ++stats.rounds;
+            stats.recomputed += candidates.size();
+            // Every candidate reads the previous round's tables.
+            next.resize(candidates.size());
+            for (size_t c = 0; c < candidates.size(); ++c)
+                next[c] = recompute(candidates[c] / n, candidates[c] % n);
+            changed.clear();
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                Route& r = routes[candidates[c]];
+                if (r.cost != next[c].cost || r.hop != next[c].hop) {
+                    r = next[c];
+                    changed.push_back(candidates[c]);
+                }
+            }
+            candidates.clear();
+            scheduleDependents();
+        }
+        return stats;
+    }
+
+    const CSRGraph& graph;
+    const CSRGraph& incoming;
+    int n;
+    LoopPrevention policy;
+    Cost infinity;
+    vector<Route> routes;      // n x n, row v is node v's routing table
+    vector<int> stamp;         // round in which an entry was last scheduled
+    int round = 0;
+    vector<size_t> candidates, changed;
+};
+
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*
+ * What-if analysis: computes LSR and DV routes once from scratch, then
+ * applies each link update and repairs both incrementally, reporting the
+ * work and time of every repair next to the full run. With verify, every
+ * repaired table is checked against Dijkstra rerun from scratch.
+ */
+void simulateLinkUpdates(CSRGraph& graph, const vector<LinkUpdate>& updates, int threads,
+                         LoopPrevention policy, bool verify, TableOutput& out) {
+    int n = graph.n;
+    requirePositiveLinks(graph, "--updates");
+    CSRGraph incoming = reverseGraph(graph);
+    IncrementalLSR lsr(graph, incoming, threads);
+    // The DV infinity has to hold for every cost the updates can set.
+    int maxCost = maxLinkCost(graph);
+    for (const LinkUpdate& up : updates)
+        if (up.cost != NO_LINK) maxCost = max(maxCost, up.cost);
+    IncrementalDV dv(graph, incoming, policy, dvInfinity(n, maxCost));
+
+    auto start = chrono::steady_clock::now();
+    long long fullNodes = lsr.computeAll();
+    double fullLSR = secondsSince(start);
+    start = chrono::steady_clock::now();
+    IncrementalDV::RunStats fullDV = dv.computeAll();
+    double fullDVTime = secondsSince(start);
+
+    cout << "--- Incremental Route Updates ---\n" << fixed << setprecision(3);
+    cout << "full run\tLSR " << fullNodes << " nodes " << fullLSR * 1000 << " ms\tDV "
+         << fullDV.rounds << " rounds " << fullDV.recomputed << " entries " << fullDVTime * 1000 << " ms\n";
+    cout << "update\tlink\told\tnew\tlsr_nodes\tlsr_ms\tlsr_speedup\tdv_rounds\tdv_entries\tdv_ms\tdv_speedup\n";
+
+    IndexedHeap heap;
+    vector<Cost> dist(n);
+    vector<int> nextHop(n);
+    for (size_t k = 0; k < updates.size(); ++k) {
+        const LinkUpdate& up = updates[k];
+        long long lsrNodes = 0;
+        IncrementalDV::RunStats dvStats;
+        double lsrTime = 0, dvTime = 0;
+        int oldCost = NO_LINK;
+        // The undirected link is changed one direction at a time, repairing
+        // the tables after each.
+        for (int dir = 0; dir < 2; ++dir) {
+            int a = dir ? up.v : up.u, b = dir ? up.u : up.v;
+            int old = setLinkCost(graph, a, b, up.cost);
+            setLinkCost(incoming, b, a, up.cost);
+            if (dir == 0) oldCost = old;
+            if (old == up.cost) continue;
+
+            start = chrono::steady_clock::now();
+            lsrNodes += lsr.linkChanged(a, b, old);
+            lsrTime += secondsSince(start);
+
+            start = chrono::steady_clock::now();
+            IncrementalDV::RunStats s = dv.linkChanged(a);
+            dvTime += secondsSince(start);
+            dvStats.rounds += s.rounds;
+            dvStats.recomputed += s.recomputed;
+        }
+        cout << k + 1 << "\t" << up.u << "-" << up.v << "\t" << oldCost << "\t" << up.cost << "\t"
+             << lsrNodes << "\t" << lsrTime * 1000 << "\t";
+        if (lsrTime > 0) cout << fullLSR / lsrTime; else cout << "-";
+        cout << "\t" << dvStats.rounds << "\t" << dvStats.recomputed << "\t" << dvTime * 1000 << "\t";
+        if (dvTime > 0) cout << fullDVTime / dvTime; else cout << "-";
+        cout << "\n";
+
+        if (!verify) continue;
+        for (int src = 0; src < n; ++src) {
+            dijkstraNextHops(graph, src, heap, dist.data(), nextHop.data());
+            const Route* dvRow = dv.table(src);
+            for (int x = 0; x < n; ++x) {
+                if (lsr.costs(src)[x] != dist[x] || dvRow[x].cost != dist[x]) {
+                    cerr << "Error: After update " << k + 1 << " route " << src << " -> " << x << " costs "
+                         << dist[x] << " but LSR has " << lsr.costs(src)[x] << " and DV " << dvRow[x].cost << endl;
+                    exit(1);
+                }
+            }
+        }
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+
+    cout << "\n--- DV Tables After Updates ---\n";
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            dist[j] = dv.table(i)[j].cost;
+            nextHop[j] = dv.table(i)[j].hop;
+        }
+        out.table(TableKind::DVR, i, dist.data(), nextHop.data());
+    }
+    out.flush();
+    cout << "\n--- LSR Tables After Updates ---\n";
+    for (int i = 0; i < n; ++i) out.table(TableKind::LSR, i, lsr.costs(i), lsr.hops(i));
+    out.flush();
+}
+
+// An undirected link, as produced by the topology generators.
+struct Link {
+    int u, v, cost;
+};
+
+// Builds the graph of n nodes from undirected links, dropping self-loops and
+// keeping the cheapest of parallel links.
+CSRGraph graphFromLinks(int n, const vector<Link>& links) {
+    CSRGraph graph;
+    graph.n = n;
+    graph.offset.assign(n + 1, 0);
+    for (const Link& l : links) {
+        if (l.u == l.v) continue;
+        ++graph.offset[l.u + 1];
+        ++graph.offset[l.v + 1];
+    }
+    for (int u = 0; u < n; ++u) graph.offset[u + 1] += graph.offset[u];
+    graph.edges.resize(graph.offset[n]);
+    vector<size_t> fill(graph.offset.begin(), graph.offset.end() - 1);
+    for (const Link& l : links) {
+        if (l.u == l.v) continue;
+        graph.edges[fill[l.u]++] = {l.v, l.cost};
+        graph.edges[fill[l.v]++] = {l.u, l.cost};
+    }
+    normalizeCSR(graph);
     return graph;
 }
 
+struct BenchOptions {
+    vector<string> topologies = {"grid", "er", "ba", "fattree"};
+    vector<int> sizes = {1000, 2000, 4000};
+    vector<int> threads;             // defaults to the -t thread count
+    vector<string> phases = {"dvr", "lsr"};
+    unsigned long long seed = 1;
+    int maxCost = 100;               // link costs are uniform in [1, maxCost]
+    int degree = 8;                  // average degree of er and ba
+    bool json = false;               // JSON lines instead of CSV
+};
+
+/*
+ * Seeded topology generators for the benchmark. All of them draw link costs
+ * uniformly from [1, maxCost], so the same seed gives the same graph.
+ *   - grid: nodes on a near-square grid, linked to their 4 neighbours;
+ *   - er: Erdos-Renyi G(n, m), m = n * degree / 2 distinct random links
+ *     (pairs already linked and self-loops are drawn again);
+ *   - ba: Barabasi-Albert preferential attachment, each new node linking to
+ *     degree / 2 existing nodes chosen with probability proportional to
+ *     their degree (a few hubs, many leaves);
+ *   - fattree: the largest k-ary fat-tree (k even) with at most n nodes:
+ *     (k/2)^2 core switches, k pods of k/2 aggregation and k/2 edge
+ *     switches, and k/2 hosts below every edge switch. The smallest one
+ *     (k = 2) has 7 nodes.
+ */
+CSRGraph generateTopology(const string& name, int n, const BenchOptions& opt) {
+    mt19937_64 rng(opt.seed);
+    uniform_int_distribution<int> cost(1, opt.maxCost);
+    vector<Link> links;
+
+    if (name == "grid") {
+        int cols = max((int)sqrt((double)n), 1);
+        for (int v = 0; v < n; ++v) {
+            if ((v + 1) % cols != 0 && v + 1 < n) links.push_back({v, v + 1, cost(rng)});
+            if (v + cols < n) links.push_back({v, v + cols, cost(rng)});
+        }
+    } else if (name == "er") {
+        uniform_int_distribution<int> node(0, n - 1);
+        long long m = min((long long)n * opt.degree / 2, (long long)n * (n - 1) / 2);
+        unordered_set<long long> linked;
+        while ((long long)links.size() < m) {
+            int u = node(rng), v = node(rng);
+            if (u == v || !linked.insert((long long)min(u, v) * n + max(u, v)).second) continue;
+            links.push_back({u, v, cost(rng)});
+        }
+    } else if (name == "ba") {
+        int m = max(opt.degree / 2, 1);
+        int seedNodes = min(m + 1, n);
+        vector<int> endpoints; // every node once per link it has
+        for (int u = 0; u < seedNodes; ++u)
+            for (int v = u + 1; v < seedNodes; ++v) {
+                links.push_back({u, v, cost(rng)});
+                endpoints.push_back(u);
+                endpoints.push_back(v);
+            }
+        vector<int> targets;
+        for (int v = seedNodes; v < n; ++v) {
+            targets.clear();
+            while ((int)targets.size() < m) {
+                int t = endpoints[uniform_int_distribution<size_t>(0, endpoints.size() - 1)(rng)];
+                if (find(targets.begin(), targets.end(), t) == targets.end()) targets.push_back(t);
+            }
+            for (int t : targets) {
+                links.push_back({v, t, cost(rng)});
+                endpoints.push_back(v);
+                endpoints.push_back(t);
+            }
+        }
+    } else if (name == "fattree") {
+        auto size = [](int k) { return 5 * k * k / 4 + k * k * k / 4; };
+        if (n < size(2)) {
+            cerr << "Error: A fat-tree needs at least " << size(2) << " nodes" << endl;
+            exit(1);
+        }
+        int k = 2;
+        while (size(k + 2) <= n) k += 2;
+        int h = k / 2, core = h * h;
+        n = size(k);
+        // Pod p holds aggregation switches core + p*k + [0, h) and edge
+        // switches core + p*k + [h, k); hosts follow all pods.
+        int hosts = core + k * k;
+        for (int p = 0; p < k; ++p) {
+            int pod = core + p * k;
+            for (int a = 0; a < h; ++a) {
+                for (int c = 0; c < h; ++c) links.push_back({a * h + c, pod + a, cost(rng)});
+                for (int e = 0; e < h; ++e) links.push_back({pod + a, pod + h + e, cost(rng)});
+            }
+            for (int e = 0; e < h; ++e)
+                for (int x = 0; x < h; ++x) links.push_back({pod + h + e, hosts++, cost(rng)});
+        }
+    } else {
+        cerr << "Error: Unknown topology '" << name << "' (expected grid, er, ba or fattree)" << endl;
+        exit(1);
+    }
+    return graphFromLinks(n, links);
+}
+
+// Peak resident set size in KiB. On Linux the peak can be reset before each
+// phase; elsewhere getrusage only reports the peak of the whole process.
+// Memory freed by the last phase is handed back first so it is not counted.
+void resetPeakRSS() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
+
+long long peakRSSKB() {
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return atoll(line.c_str() + 6);
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Sum of all reachable costs, so runs of different phases on one graph can
+// be checked against each other.
+struct CostChecksum {
+    unsigned long long sum = 0;
+    void add(const Cost* dist, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+            if (dist[i] != INF) sum += dist[i];
+    }
+};
+
+struct BenchResult {
+    string topology, phase;
+    int nodes, threads;
+    size_t links;
+    double seconds;
+    long long rounds;         // DVR rounds, async DV convergence ticks
+    long long peakRSS;
+    unsigned long long checksum;
+};
+
+void printBenchResult(const BenchResult& r, const BenchOptions& opt) {
+    if (opt.json) {
+        cout << "{\"topology\":\"" << r.topology << "\",\"nodes\":" << r.nodes << ",\"links\":" << r.links
+             << ",\"seed\":" << opt.seed << ",\"max_cost\":" << opt.maxCost << ",\"threads\":" << r.threads
+             << ",\"phase\":\"" << r.phase << "\",\"seconds\":" << r.seconds << ",\"rounds\":" << r.rounds
+             << ",\"peak_rss_kb\":" << r.peakRSS << ",\"checksum\":" << r.checksum << "}\n";
+    } else {
+        cout << r.topology << "," << r.nodes << "," << r.links << "," << opt.seed << "," << opt.maxCost << ","
+             << r.threads << "," << r.phase << "," << r.seconds << "," << r.rounds << "," << r.peakRSS << ","
+             << r.checksum << "\n";
+    }
+    cout.flush();
+}
+
+/*
+ * Benchmark suite: for every topology and size, generates the graph and
+ * times each phase on its own (DVR, LSR for all sources, async DV), once per
+ * thread count. Tables are computed but not printed. Every phase reports
+ * its wall time, peak RSS and a checksum of the route costs, one CSV row or
+ * JSON line per run. DVR keeps two n x n cost matrices, so it is the phase
+ * that bounds the size of a run.
+ */
+void runBenchmarks(const BenchOptions& opt) {
+    for (const string& phase : opt.phases) {
+        if (phase != "dvr" && phase != "lsr" && phase != "async") {
+            cerr << "Error: Unknown phase '" << phase << "' (expected dvr, lsr or async)" << endl;
+            exit(1);
+        }
+    }
+    if (!opt.json) cout << "topology,nodes,links,seed,max_cost,threads,phase,seconds,rounds,peak_rss_kb,checksum\n";
+    cout << fixed << setprecision(6);
+
+    for (const string& topology : opt.topologies) {
+        for (int size : opt.sizes) {
+            resetPeakRSS();
+            auto start = chrono::steady_clock::now();
+            CSRGraph graph = generateTopology(topology, max(size, 1), opt);
+            BenchResult r{topology, "generate", graph.n, 1, graph.edges.size() / 2,
+                          secondsSince(start), 0, peakRSSKB(), 0};
+            printBenchResult(r, opt);
+
+            for (const string& phase : opt.phases) {
+                for (int threads : opt.threads) {
+                    // The simulator is single-threaded: run it once.
+                    if (phase == "async" && threads != opt.threads.front()) continue;
+                    r.phase = phase;
+                    r.threads = phase == "async" ? 1 : threads;
+                    CostChecksum checksum;
+                    resetPeakRSS();
+                    start = chrono::steady_clock::now();
+                    if (phase == "dvr") {
+                        requireDenseTables(graph.n, dvrEntryBytes(graph), "The dvr phase");
+                        vector<Cost> dist;
+                        vector<int> nextHop;
+                        r.rounds = computeDVR(graph, threads, dist, nextHop);
+                        r.seconds = secondsSince(start);
+                        checksum.add(dist.data(), dist.size());
+                    } else if (phase == "lsr") {
+                        vector<int> sources(graph.n);
+                        for (int v = 0; v < graph.n; ++v) sources[v] = v;
+                        forEachLSRBlock(graph, sources, threads, [&](int, int rows, const Cost* dist, const int*) {
+                            checksum.add(dist, (size_t)rows * graph.n);
+                        });
+                        r.rounds = 0;
+                        r.seconds = secondsSince(start);
+                    } else {
+                        requireDenseTables(graph.n, ASYNC_DV_ENTRY_BYTES, "The async phase");
+                        AsyncDVSimulator sim(graph, 0, LoopPrevention::PoisonReverse);
+                        r.rounds = sim.run().convergenceTime;
+                        r.seconds = secondsSince(start);
+                        for (int v = 0; v < graph.n; ++v)
+                            for (int x = 0; x < graph.n; ++x)
+                                if (sim.table(v)[x].cost != INF) checksum.sum += sim.table(v)[x].cost;
+                    }
+                    r.peakRSS = peakRSSKB();
+                    r.checksum = checksum.sum;
+                    printBenchResult(r, opt);
+                }
+            }
+        }
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Parses a command-line integer in [low, high]; anything else, including
+// trailing characters, is an error rather than a silently different run.
+long long parseNumber(const string& text, const string& option, long long low, long long high) {
+    char* end;
+    errno = 0;
+    long long value = strtoll(text.c_str(), &end, 10);
+    if (!isdigit((unsigned char)text[0]) || *end != '\0' || errno == ERANGE || value < low || value > high) {
+        cerr << "Error: Invalid value '" << text << "' for " << option << " (expected an integer from " << low
+             << " to " << high << ")" << endl;
+        exit(1);
+    }
+    return value;
+}
+
 int main(int argc, char *argv[]) {
-    if (argc != 2) {
-        cerr << "Usage: " << argv[0] << " <input_file>\n";
+    int threads = max<int>(thread::hardware_concurrency(), 1);
+    bool asyncDV = false, lsrOnly = false;
+    int linkDelay = 0;
+    LoopPrevention policy = LoopPrevention::PoisonReverse;
+    string updatesFile, eventsFile;
+    bool verify = false;
+    OutputOptions output;
+    bool bench = false;
+    BenchOptions benchOptions;
+    string filename;
+    // Comma-separated lists of the benchmark options
+    auto splitList = [](const string& list) {
+        vector<string> items;
+        stringstream ss(list);
+        string item;
+        while (getline(ss, item, ',')) if (!item.empty()) items.push_back(item);
+        return items;
+    };
+    const int MAX_THREADS = 4096;
+    auto intList = [&](const string& list, const string& option, int high) {
+        vector<int> values;
+        for (const string& item : splitList(list)) values.push_back(parseNumber(item, option, 1, high));
+        if (values.empty()) parseNumber(list, option, 1, high); // reports the empty list
+        return values;
+    };
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+            threads = parseNumber(argv[++i], arg, 1, MAX_THREADS);
+        } else if (arg == "--updates" && i + 1 < argc) {
+            updatesFile = argv[++i];
+        } else if (arg == "--events" && i + 1 < argc) {
+            eventsFile = argv[++i];
+        } else if (arg == "--nodes" && i + 1 < argc) {
+            output.nodes = argv[++i];
+        } else if (arg == "--csv" && i + 1 < argc) {
+            output.csvFile = argv[++i];
+        } else if (arg == "--binary" && i + 1 < argc) {
+            output.binaryFile = argv[++i];
+        } else if (arg == "--diff" && i + 1 < argc) {
+            output.diffFile = argv[++i];
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "--lsr-only") {
+            lsrOnly = true;
+        } else if (arg == "--async-dv") {
+            asyncDV = true;
+        } else if (arg == "--delay" && i + 1 < argc) {
+            linkDelay = parseNumber(argv[++i], arg, 0, INT_MAX);
+        } else if (arg == "--no-split-horizon") {
+            policy = LoopPrevention::None;
+        } else if (arg == "--split-horizon") {
+            policy = LoopPrevention::SplitHorizon;
+        } else if (arg == "--poison-reverse") {
+            policy = LoopPrevention::PoisonReverse;
+        } else if (arg == "--bench") {
+            bench = true;
+        } else if (arg == "--topology" && i + 1 < argc) {
+            benchOptions.topologies = splitList(argv[++i]);
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            benchOptions.sizes = intList(argv[++i], arg, INT_MAX);
+        } else if (arg == "--bench-threads" && i + 1 < argc) {
+            benchOptions.threads = intList(argv[++i], arg, MAX_THREADS);
+        } else if (arg == "--phases" && i + 1 < argc) {
+            benchOptions.phases = splitList(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            benchOptions.seed = parseNumber(argv[++i], arg, 0, LLONG_MAX);
+        } else if (arg == "--max-cost" && i + 1 < argc) {
+            benchOptions.maxCost = parseNumber(argv[++i], arg, 1, INT_MAX);
+        } else if (arg == "--degree" && i + 1 < argc) {
+            benchOptions.degree = parseNumber(argv[++i], arg, 1, INT_MAX);
+        } else if (arg == "--json") {
+            benchOptions.json = true;
+        } else if (filename.empty() && arg[0] != '-') {
+            filename = arg;
+        } else {
+            filename.clear();
+            break;
+        }
+    }
+    // The modes exclude each other; silently running only one is worse
+    if (lsrOnly + asyncDV + !updatesFile.empty() + bench > 1) {
+        cerr << "Error: --lsr-only, --async-dv, --updates and --bench cannot be combined" << endl;
+        return 1;
+    }
+    if (!eventsFile.empty() && !asyncDV) {
+        cerr << "Error: --events needs --async-dv (use --updates for synchronous what-if analysis)" << endl;
+        return 1;
+    }
+
+    if (bench) {
+        if (benchOptions.threads.empty()) benchOptions.threads = {threads};
+        runBenchmarks(benchOptions);
+        return 0;
+    }
+    if (filename.empty()) {
+        cerr << "Usage: " << argv[0] << " [-t threads] [--lsr-only | --async-dv [--delay ticks] [--events <event_file>]\n"
+             << "           [--poison-reverse | --split-horizon | --no-split-horizon]] <input_file>\n"
+             << "       " << argv[0] << " [-t threads] --updates <update_file> [--verify]\n"
+             << "           [--poison-reverse | --split-horizon | --no-split-horizon] <input_file>\n"
+             << "       " << argv[0] << " --bench [--topology grid,er,ba,fattree] [--sizes 1000,2000]\n"
+             << "           [--phases dvr,lsr,async] [--bench-threads 1,2,4] [--seed s] [--max-cost c]\n"
+             << "           [--degree d] [--json]\n"
+             << "Output options: --nodes <list> --csv <file> --binary <file> --diff <binary_file>\n";
         return 1;
     }
 
-    string filename = argv[1];
-    vector<vector<int>> graph = readGraphFromFile(filename);
+    CSRGraph graph = readGraphFromFile(filename);
+    TableOutput out(graph.n, output);
+
+    if (!updatesFile.empty()) {
+        requireDenseTables(graph.n, UPDATES_ENTRY_BYTES, "--updates");
+        vector<LinkUpdate> updates = readUpdatesFromFile(updatesFile, graph.n);
+        cout << "\n";
+        simulateLinkUpdates(graph, updates, threads, policy, verify, out);
+        return 0;
+    }
 
-    cout << "\n--- Distance Vector Routing Simulation ---\n";
-    simulateDVR(graph);
+    // --lsr-only skips the n x n DV tables, for networks too large for them
+    if (!lsrOnly) {
+        if (asyncDV) {
+            requireDenseTables(graph.n, ASYNC_DV_ENTRY_BYTES, "--async-dv");
+            vector<LinkEvent> linkEvents;
+            if (!eventsFile.empty()) {
+                requirePositiveLinks(graph, "--events");
+                linkEvents = readLinkEventsFromFile(eventsFile, graph.n);
+            }
+            cout << "\n--- Asynchronous Distance Vector Simulation ---\n";
+            // With link events, graph ends up as the final topology, which
+            // the LSR tables below are then computed on.
+            simulateAsyncDV(graph, linkDelay, policy, linkEvents, out);
+        } else {
+            requireDenseTables(graph.n, dvrEntryBytes(graph), "DVR");
+            cout << "\n--- Distance Vector Routing Simulation ---\n";
+            simulateDVR(graph, threads, out);
+        }
+    }
 
     cout << "\n--- Link State Routing Simulation ---\n";
-    simulateLSR(graph);
+    simulateLSR(graph, threads, out);
 
     return 0;
 }